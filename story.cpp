@@ -1,9 +1,11 @@
 #include "al/app/al_App.hpp"
 #include "al/graphics/al_Font.hpp"
 #include "al/math/al_Random.hpp"
-#include "Gamma/SamplePlayer.h"
 #include "al/io/al_File.hpp"
+#include "al/sound/al_SoundFile.hpp"
 #include "al/graphics/al_Image.hpp"
+#include "al/graphics/al_EasyFBO.hpp"
+#include "al/graphics/al_OpenGL.hpp"
 #include "al/app/al_App.hpp"
 #include "al/graphics/al_Shapes.hpp"
 #include "al/io/al_File.hpp"
@@ -14,6 +16,14 @@
 #include <fstream>
 #include <set>
 #include <algorithm>
+#include <deque>
+#include <iostream>
+#include <cmath>
+#include <numeric>
+#include <filesystem>
+#include <chrono>
+#include <cstdio>
+#include <atomic>
 
 
 struct CommonState {
@@ -35,6 +45,428 @@ std::vector<std::string> lineToWords(const std::string& line) {
     return words;
 }
 
+// whisper re-sends overlapping or repeated chunks of the transcript, so keep a
+// short rolling history of recent words and only pass on what is new. only
+// messages arriving within the re-send window are compared, anything later is
+// new speech even if it repeats earlier words
+struct TranscriptStream {
+    std::deque<std::pair<std::string, double>> history;  // recent words and when they arrived, oldest first
+    std::vector<std::string> lastMessage;
+    double lastTime = 0.0;
+    size_t maxHistory = 32;
+    size_t minOverlap = 2;      // shorter overlaps are probably the user repeating a word
+    double resendWindow = 3.0;  // seconds, about one whisper chunk
+
+    // counters for how much duplicate work was skipped
+    int messagesReceived = 0;
+    int messagesSkipped = 0;
+    int wordsReceived = 0;
+    int wordsSkipped = 0;
+
+    // returns only the words that were not already in the recent transcript,
+    // time is in seconds
+    std::vector<std::string> newWords(const std::vector<std::string>& words, double time) {
+        if (words.empty()) {
+            return words;
+        }
+        messagesReceived++;
+        wordsReceived += words.size();
+
+        // forget words that are too old to be part of a re-send
+        while (!history.empty() && time - history.front().second > resendWindow) {
+            history.pop_front();
+        }
+        bool recent = time - lastTime <= resendWindow;
+
+        size_t overlap = 0;
+        if (words.size() >= minOverlap && ((recent && words == lastMessage) || containsRun(words))) {
+            overlap = words.size(); // exact repeat
+        } else {
+            overlap = suffixPrefixOverlap(words);
+            if (recent) {
+                overlap = std::max(overlap, commonPrefix(words));
+            }
+            if (overlap < minOverlap) {
+                overlap = 0;
+            }
+        }
+
+        std::vector<std::string> delta(words.begin() + overlap, words.end());
+        wordsSkipped += overlap;
+        if (delta.empty()) {
+            messagesSkipped++;
+        }
+
+        for (const auto& w : delta) {
+            history.push_back({w, time});
+            if (history.size() > maxHistory) {
+                history.pop_front();
+            }
+        }
+        lastMessage = words;
+        lastTime = time;
+        return delta;
+    }
+
+    static bool sameWord(const std::pair<std::string, double>& entry, const std::string& word) {
+        return entry.first == word;
+    }
+
+    // true if the whole message already appears somewhere in the history
+    bool containsRun(const std::vector<std::string>& words) const {
+        return std::search(history.begin(), history.end(), words.begin(), words.end(), sameWord) != history.end();
+    }
+
+    // longest tail of the history that matches the start of the message
+    size_t suffixPrefixOverlap(const std::vector<std::string>& words) const {
+        for (size_t k = std::min(history.size(), words.size()); k > 0; k--) {
+            if (std::equal(history.end() - k, history.end(), words.begin(), sameWord)) {
+                return k;
+            }
+        }
+        return 0;
+    }
+
+    // whisper sometimes re-sends the last message with more words or with its
+    // cut off last word finished ("hello my nam" -> "hello my name is"). only
+    // count the shared start when it covers all of the previous message like
+    // that, otherwise it's a new sentence that happens to start the same way
+    size_t commonPrefix(const std::vector<std::string>& words) const {
+        size_t n = 0;
+        while (n < words.size() && n < lastMessage.size() && words[n] == lastMessage[n]) {
+            n++;
+        }
+        if (n == lastMessage.size()) {
+            return n;
+        }
+        const std::string& cut = lastMessage.back();
+        if (n + 1 == lastMessage.size() && n < words.size() && words[n].compare(0, cut.size(), cut) == 0) {
+            return n;
+        }
+        return 0;
+    }
+
+    void printStats() const {
+        std::cout << "transcript: " << messagesReceived << " messages, "
+                  << messagesSkipped << " skipped as duplicates, "
+                  << wordsSkipped << "/" << wordsReceived << " words skipped" << std::endl;
+    }
+};
+
+// a sound converted once at load time to the device rate and channel count,
+// so playback is just copying frames out of data
+struct SampleClip {
+    std::vector<float> data;  // interleaved
+    int channels = 0;
+    long frames = 0;
+};
+
+// loads the wavs in sound/, resamples them with a polyphase windowed sinc
+// filter, folds channels, normalizes the peak and keeps the result both in
+// memory and in a disk cache so the conversion only happens once
+struct SampleLibrary {
+    int sampleRate = 44100;
+    int channels = 2;
+    float peak = 0.8f;             // every clip is normalized to this peak
+    int halfTaps = 32;             // filter taps on each side of a sample
+    float cutoffScale = 0.95f;     // keeps the filter cutoff a little below nyquist
+    std::string soundDir = "sound/";
+    std::string cacheDir = "sound/cache/";
+    std::unordered_map<std::string, SampleClip> clips;
+
+    struct CacheHeader {
+        char magic[4];
+        int version;
+        int sampleRate;
+        int channels;
+        int halfTaps;
+        float peak;
+        float cutoffScale;
+        long long frames;
+        long long sourceSize;
+        long long sourceTime;
+    };
+
+    void configure(int rate, int chans) {
+        sampleRate = rate;
+        channels = chans;
+    }
+
+    void loadAll() {
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(soundDir, ec)) {
+            if (entry.path().extension() == ".wav") {
+                get(entry.path().filename().string());
+            }
+        }
+    }
+
+    // returns nullptr if the sound couldn't be loaded
+    const SampleClip* get(const std::string& name) {
+        auto it = clips.find(name);
+        if (it == clips.end()) {
+            it = clips.emplace(name, load(name)).first; // failures are stored empty so we don't retry
+        }
+        return it->second.frames > 0 ? &it->second : nullptr;
+    }
+
+    SampleClip load(const std::string& name) {
+        SampleClip clip;
+        std::string path = soundDir + name;
+        std::error_code ec;
+        long long size = std::filesystem::file_size(path, ec);
+        if (ec) {
+            std::cout << "missing sound: " << path << std::endl;
+            return clip;
+        }
+        long long time = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+
+        if (readCache(name, size, time, clip)) {
+            return clip;
+        }
+
+        SoundFile file;
+        if (!file.open(path.c_str()) || file.frameCount <= 0) {
+            std::cout << "couldn't read sound: " << path << std::endl;
+            return clip;
+        }
+
+        std::vector<std::vector<float>> folded = foldChannels(file);
+        for (auto& channel : folded) {
+            channel = resample(channel, file.sampleRate, sampleRate);
+        }
+
+        clip.channels = channels;
+        clip.frames = folded[0].size();
+        clip.data.resize(clip.frames * channels);
+        for (long i = 0; i < clip.frames; i++) {
+            for (int c = 0; c < channels; c++) {
+                clip.data[i * channels + c] = folded[c][i];
+            }
+        }
+        normalize(clip.data);
+        writeCache(name, size, time, clip);
+        return clip;
+    }
+
+    // mono is copied to every output, extra channels wrap around and get averaged
+    std::vector<std::vector<float>> foldChannels(const SoundFile& file) {
+        std::vector<std::vector<float>> out(channels, std::vector<float>(file.frameCount, 0.0f));
+        int srcChannels = std::max(file.channels, 1);
+        for (int c = 0; c < channels; c++) {
+            std::vector<int> sources;
+            if (srcChannels == 1) {
+                sources.push_back(0);
+            } else {
+                for (int s = c % srcChannels; s < srcChannels; s += channels) {
+                    sources.push_back(s);
+                }
+            }
+            float scale = 1.0f / sources.size();
+            for (long long i = 0; i < file.frameCount; i++) {
+                for (int s : sources) {
+                    out[c][i] += file.data[i * srcChannels + s] * scale;
+                }
+            }
+        }
+        return out;
+    }
+
+    // windowed sinc at fractional offset x, with cutoff relative to the input rate
+    float kernel(double x, double cutoff) {
+        if (std::abs(x) >= halfTaps) {
+            return 0.0f;
+        }
+        double t = M_PI * x * cutoff;
+        double sinc = (x == 0.0) ? 1.0 : std::sin(t) / t;
+        double w = 0.5 * (1.0 + x / halfTaps); // blackman window over [-halfTaps, halfTaps]
+        double blackman = 0.42 - 0.5 * std::cos(2.0 * M_PI * w) + 0.08 * std::cos(4.0 * M_PI * w);
+        return float(cutoff * sinc * blackman);
+    }
+
+    // polyphase resampling by the ratio up/down; each output sample only needs
+    // the filter phase for its fractional position, so the phases are precomputed
+    std::vector<float> resample(const std::vector<float>& in, int inRate, int outRate) {
+        if (inRate == outRate || inRate <= 0) {
+            return in;
+        }
+        long g = std::gcd(inRate, outRate);
+        long up = outRate / g;
+        long down = inRate / g;
+        double cutoff = std::min(1.0, double(outRate) / inRate) * cutoffScale;
+
+        int taps = 2 * halfTaps;
+        std::vector<float> phases(up * taps);
+        for (long p = 0; p < up; p++) {
+            for (int k = 0; k < taps; k++) {
+                phases[p * taps + k] = kernel(k - halfTaps + 1 - double(p) / up, cutoff);
+            }
+        }
+
+        long outFrames = long((long long)in.size() * up / down);
+        std::vector<float> out(outFrames);
+        for (long n = 0; n < outFrames; n++) {
+            long long pos = (long long)n * down;
+            long base = long(pos / up);
+            long p = long(pos % up);
+            const float* h = &phases[p * taps];
+            float sum = 0.0f;
+            for (int k = 0; k < taps; k++) {
+                long i = base + k - halfTaps + 1;
+                if (i >= 0 && i < (long)in.size()) {
+                    sum += in[i] * h[k];
+                }
+            }
+            out[n] = sum;
+        }
+        return out;
+    }
+
+    void normalize(std::vector<float>& data) {
+        float max = 0.0f;
+        for (float s : data) {
+            max = std::max(max, std::abs(s));
+        }
+        if (max > 0.0f) {
+            float gain = peak / max;
+            for (float& s : data) {
+                s *= gain;
+            }
+        }
+    }
+
+    std::string cachePath(const std::string& name) {
+        return cacheDir + name + ".f32";
+    }
+
+    // the cache is only used if it matches the source file, device setup and
+    // conversion settings, anything else gets converted again
+    bool readCache(const std::string& name, long long size, long long time, SampleClip& clip) {
+        std::ifstream in(cachePath(name), std::ios::binary);
+        CacheHeader h;
+        if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))) {
+            return false;
+        }
+        if (std::string(h.magic, 4) != "AVSC" || h.version != 2 || h.sampleRate != sampleRate ||
+            h.channels != channels || h.halfTaps != halfTaps || h.peak != peak ||
+            h.cutoffScale != cutoffScale || h.sourceSize != size || h.sourceTime != time || h.frames <= 0) {
+            return false;
+        }
+
+        // a truncated or corrupt file shouldn't make us allocate whatever frames says
+        std::error_code ec;
+        long long fileSize = std::filesystem::file_size(cachePath(name), ec);
+        if (ec || (fileSize - (long long)sizeof(h)) / ((long long)sizeof(float) * h.channels) != h.frames ||
+            (fileSize - (long long)sizeof(h)) % ((long long)sizeof(float) * h.channels) != 0) {
+            return false;
+        }
+        clip.channels = h.channels;
+        clip.frames = h.frames;
+        clip.data.resize(h.frames * h.channels);
+        if (!in.read(reinterpret_cast<char*>(clip.data.data()), clip.data.size() * sizeof(float))) {
+            clip = SampleClip();
+            return false;
+        }
+        return true;
+    }
+
+    void writeCache(const std::string& name, long long size, long long time, const SampleClip& clip) {
+        std::error_code ec;
+        std::filesystem::create_directories(cacheDir, ec);
+        std::ofstream out(cachePath(name), std::ios::binary);
+        if (!out) {
+            return; // cache is optional
+        }
+        CacheHeader h{{'A', 'V', 'S', 'C'}, 2, sampleRate, channels, halfTaps, peak, cutoffScale,
+                      clip.frames, size, time};
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(clip.data.data()), clip.data.size() * sizeof(float));
+    }
+};
+
+// renders a scripted session to numbered frames plus a wav of the triggered
+// sounds instead of running live. each transcript line is "<seconds> <text>"
+struct OfflineRender {
+    bool enabled = false;     // set before the app starts and never changed after
+    bool finished = false;
+    std::string outDir = "render/";
+    double dt = 1.0 / 30.0;   // fixed step per frame
+    double tail = 10.0;       // seconds to keep rendering after the last line
+    int width = 1280;
+    int height = 720;
+    int sampleRate = 44100;   // format of mix.wav, independent of the audio device
+    int channels = 2;
+    double tickBudget = 0.05; // seconds of work per window frame before yielding
+
+    std::vector<std::pair<double, std::string>> lines;
+    size_t nextLine = 0;
+    double simTime = 0.0;
+    double duration = 0.0;
+    int frame = 0;
+    std::vector<float> audio;  // interleaved mix of the triggered samples
+    std::chrono::steady_clock::time_point startTime;
+
+    bool load(const std::string& path, const std::string& dir) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cout << "couldn't open transcript: " << path << std::endl;
+            return false;
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            std::stringstream ss(line);
+            double time;
+            if (line.empty() || line[0] == '#' || !(ss >> time)) {
+                continue; // comments and lines without a time
+            }
+            std::string text;
+            std::getline(ss >> std::ws, text);
+            lines.push_back({time, text});
+        }
+        std::stable_sort(lines.begin(), lines.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        outDir = dir;
+        if (!outDir.empty() && outDir.back() != '/') {
+            outDir += "/";
+        }
+        std::error_code ec;
+        std::filesystem::create_directories(outDir, ec);
+        duration = (lines.empty() ? 0.0 : lines.back().first) + tail;
+        enabled = true;
+        return true;
+    }
+
+    bool done() const {
+        return simTime >= duration;
+    }
+
+    std::string framePath() const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%05d.png", frame);
+        return outDir + name;
+    }
+
+    // 32 bit float wav
+    void writeWav(int sampleRate, int channels) {
+        std::ofstream out(outDir + "mix.wav", std::ios::binary);
+        auto u32 = [&](uint32_t v) { out.write(reinterpret_cast<const char*>(&v), 4); };
+        auto u16 = [&](uint16_t v) { out.write(reinterpret_cast<const char*>(&v), 2); };
+        uint32_t bytes = audio.size() * sizeof(float);
+        out.write("RIFF", 4); u32(36 + bytes); out.write("WAVE", 4);
+        out.write("fmt ", 4); u32(16); u16(3); u16(channels); u32(sampleRate);
+        u32(sampleRate * channels * sizeof(float)); u16(channels * sizeof(float)); u16(32);
+        out.write("data", 4); u32(bytes);
+        out.write(reinterpret_cast<const char*>(audio.data()), bytes);
+    }
+
+    void report() const {
+        double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        std::cout << "offline: " << frame << " frames (" << simTime << "s) in " << wall << "s, "
+                  << frame / wall << " fps, " << simTime / wall << "x real time" << std::endl;
+    }
+};
+
 struct LetterAgent {
     char c;
     Vec3f pos;
@@ -223,9 +655,15 @@ struct LetterAgent {
 class MyApp : public App {
   Font font;
   Mesh mesh, mesh2; 
-  gam::SamplePlayer<float, gam::ipl::Linear> player;
+  SampleLibrary samples;
+  const SampleClip* clip = nullptr;  // sound currently playing
+  long playPos = 0;
   std::vector<LetterAgent> letterAgents;
   std::string filename;
+  TranscriptStream transcript;
+  std::vector<float> soundFrame;  // one output frame for onSound
+  EasyFBO offlineFbo;
+  std::vector<unsigned char> offlinePixels;
 
   float level = 0.0f;
   float globalTime = 0.0f;
@@ -236,7 +674,13 @@ class MyApp : public App {
 
   float letterOpacity = 1.0f;
 
-  bool isAudioPlaying = false;
+  // set last by the message thread, after clip and playPos, and cleared by the audio thread
+  std::atomic<bool> isAudioPlaying{false};
+
+ public:
+  OfflineRender offline;  // set up from main when rendering a script
+
+ private:
 
   // background variations 
 
@@ -267,332 +711,377 @@ class MyApp : public App {
   float wordHeight = 0.5f; 
   RGB background{0.0, 0.0, 0.0}; 
 
+  void onInit() override {
+    // sized before the audio domain starts calling onSound
+    if (!offline.enabled) {
+      soundFrame.resize(audioIO().channelsOut());
+    }
+  }
+
   void onCreate() override {
     nav().pos(0, 3, 30);
     nav().setHome();
     font.load("arial.ttf", fontSize, 2048);
     font.alignCenter();
-  } 
 
-  void onMessage(osc::Message& m) override {
+    // convert every sound up front so onSound only copies frames
+    if (offline.enabled) {
+      samples.configure(offline.sampleRate, offline.channels);
+    } else {
+      samples.configure(audioIO().framesPerSecond(), audioIO().channelsOut());
+    }
+    samples.loadAll();
 
-    if (isAudioPlaying) {
-      return; // ignore the osc message
-    }    
+    if (offline.enabled) {
+      rnd::global().seed(1); // same script renders the same frames
+      offlineFbo.init(offline.width, offline.height);
+      offlinePixels.resize(offline.width * offline.height * 4);
+      offline.startTime = std::chrono::steady_clock::now();
+    }
+  } 
+
+  void onExit() override {
+    transcript.printStats();
+  }
 
+  void onMessage(osc::Message& m) override {
+    if (offline.enabled) {
+      return; // the script is the only input, and it runs on the graphics thread
+    }
     if (m.addressPattern() == "/whisper") {
       std::string text;
       m >> text;
+      double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+      handleTranscript(text, now);
+    }
+  }
 
-      if (text.find("[BLANK_AUDIO]") != std::string::npos || text.find("[SOUND]") != std::string::npos || text.find("[SOUNDS]") != std::string::npos ) {
-        return; // ignore if blank audio 
-      }
+  // shared by live whisper messages and offline transcripts
+  // time is in seconds and only used to spot whisper re-sends
+  void handleTranscript(std::string text, double time) {
+    if (isAudioPlaying) {
+      return; // ignore the message
+    }
 
-      std::transform(text.begin(), text.end(), text.begin(), ::tolower);
-      text.erase(std::remove_if(text.begin(), text.end(), ::ispunct), text.end());
-      
-      for (auto& word : lineToWords(text)) {
-        if (color_word.find(word) != color_word.end()) {
-          background = color_word[word];
-        }
+    if (text.find("[BLANK_AUDIO]") != std::string::npos || text.find("[SOUND]") != std::string::npos || text.find("[SOUNDS]") != std::string::npos ) {
+      return; // ignore if blank audio
+    }
 
-        if (size_word.find(word) != size_word.end()) {
-          wordHeight = size_word[word]; 
-        }
-        
-        if (distance_word.find(word) != distance_word.end()) {
-         groupDist = distance_word[word];
-        }
+    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+    text.erase(std::remove_if(text.begin(), text.end(), ::ispunct), text.end());
 
-        if (opacity_word.find(word) != opacity_word.end()) {
-          letterOpacity = opacity_word[word];
-        }
+    // only the words that weren't already sent go to keywords and agents
+    std::vector<std::string> delta = transcript.newWords(lineToWords(text), time);
+    if (delta.empty()) {
+      return; // nothing new in this message
+    }
+    text.clear();
+    for (const auto& word : delta) {
+      if (!text.empty()) text += " ";
+      text += word;
     }
 
-      // speed 
-      if (text.find("freeze") != std::string::npos) {
-          isFrozen = true;
+    for (auto& word : delta) {
+      if (color_word.find(word) != color_word.end()) {
+        background = color_word[word];
       }
-      
-      if (text.find("unfreeze") != std::string::npos) {
-          isFrozen = false;
-      }
-      
-      if (text.find("faster") != std::string::npos) {
-          speedMultiplier = std::min(speedMultiplier * 1.5f, 5.0f); // can only go up to 5x
+
+      if (size_word.find(word) != size_word.end()) {
+        wordHeight = size_word[word];
       }
-      
-      if (text.find("slower") != std::string::npos) {
-          speedMultiplier = std::max(speedMultiplier * 0.67f, 0.1f); // maxing speed
+
+      if (distance_word.find(word) != distance_word.end()) {
+        groupDist = distance_word[word];
       }
-      
-      if (text.find("normal") != std::string::npos) {
-          speedMultiplier = 1.0f;
+
+      if (opacity_word.find(word) != opacity_word.end()) {
+        letterOpacity = opacity_word[word];
       }
+    }
 
-      if (text.find("reset") != std::string::npos) {
-        letterAgents.clear(); 
+    // speed
+    if (text.find("freeze") != std::string::npos) {
+      isFrozen = true;
     }
-        
-      // sounds
 
-      bool shouldPlaySound = false;
+    if (text.find("unfreeze") != std::string::npos) {
+      isFrozen = false;
+    }
 
+    if (text.find("faster") != std::string::npos) {
+      speedMultiplier = std::min(speedMultiplier * 1.5f, 5.0f); // can only go up to 5x
+    }
 
-      if (text.find("bath") != std::string::npos || text.find("water") != std::string::npos || text.find("waves") != std::string::npos || text.find("shore") != std::string::npos) {
-          player.load("wave.wav"); 
-          shouldPlaySound = true;
-      }
-      else if (text.find("park") != std::string::npos || text.find("children") != std::string::npos || text.find("kids") != std::string::npos || text.find("playing") != std::string::npos) {
-          player.load("kids.wav"); 
-          shouldPlaySound = true;
-      }
-      else if (text.find("squirrels") != std::string::npos) {
-          player.load("squirrel.wav"); 
-          shouldPlaySound = true;
-      }
+    if (text.find("slower") != std::string::npos) {
+      speedMultiplier = std::max(speedMultiplier * 0.67f, 0.1f); // maxing speed
+    }
 
-      else if (text.find("public transportation") != std::string::npos || text.find("public transportation") != std::string::npos || text.find("train") != std::string::npos) {
-        player.load("train.wav"); 
-        shouldPlaySound = true;
-      }
+    if (text.find("normal") != std::string::npos) {
+      speedMultiplier = 1.0f;
+    }
 
-      else if (text.find("in the car") != std::string::npos || text.find("driving") != std::string::npos || text.find("cars") != std::string::npos) {
-        player.load("turnsignal.wav");
-        shouldPlaySound = true; 
+    if (text.find("reset") != std::string::npos) {
+      letterAgents.clear();
     }
 
-      else if (text.find("called") != std::string::npos) {
-        player.load("vibrate.wav"); 
-        shouldPlaySound = true;
-      }
+    // sounds
 
-      else if (text.find("calling") != std::string::npos) {
-        player.load("phonecall.wav"); 
-        shouldPlaySound = true;
-      }
+    bool shouldPlaySound = false;
 
-      else if (text.find("find") != std::string::npos) {
-        player.load("search.wav"); 
-        shouldPlaySound = true;
-      } 
 
-      else if (text.find("typing") != std::string::npos || text.find("keyboard") != std::string::npos || text.find("computer") != std::string::npos) {
-        player.load("clicking-keyboard.wav");
-        shouldPlaySound = true;
+    if (text.find("bath") != std::string::npos || text.find("water") != std::string::npos || text.find("waves") != std::string::npos || text.find("shore") != std::string::npos) {
+      clip = samples.get("wave.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("pen") != std::string::npos || text.find("writing") != std::string::npos || text.find("click") != std::string::npos) {
-        player.load("clicking-pen.wav");
-        shouldPlaySound = true;
+    else if (text.find("park") != std::string::npos || text.find("children") != std::string::npos || text.find("kids") != std::string::npos || text.find("playing") != std::string::npos) {
+      clip = samples.get("kids.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("coffee") != std::string::npos || text.find("brewing") != std::string::npos || text.find("machine") != std::string::npos) {
-        player.load("coffee-machine.wav");
-        shouldPlaySound = true;
+    else if (text.find("squirrels") != std::string::npos) {
+      clip = samples.get("squirrel.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("cutting") != std::string::npos || text.find("chopping") != std::string::npos || text.find("vegetables") != std::string::npos || text.find("fruit") != std::string::npos) {
-        player.load("cutfruitveg.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("public transportation") != std::string::npos || text.find("public transportation") != std::string::npos || text.find("train") != std::string::npos) {
+      clip = samples.get("train.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("door") != std::string::npos || text.find("keys") != std::string::npos || text.find("unlocking") != std::string::npos) {
-        player.load("door-unlocking-with-keys.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("in the car") != std::string::npos || text.find("driving") != std::string::npos || text.find("cars") != std::string::npos) {
+      clip = samples.get("turnsignal.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("drawer") != std::string::npos || text.find("opening") != std::string::npos || text.find("cabinet") != std::string::npos) {
-        player.load("drawer-opening.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("called") != std::string::npos) {
+      clip = samples.get("vibrate.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("drawing") != std::string::npos || text.find("sketching") != std::string::npos || text.find("art") != std::string::npos) {
-        player.load("drawing.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("calling") != std::string::npos) {
+      clip = samples.get("phonecall.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("fire") != std::string::npos || text.find("flames") != std::string::npos || text.find("burning") != std::string::npos) {
-        player.load("fire.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("find") != std::string::npos) {
+      clip = samples.get("search.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("fishing") != std::string::npos || text.find("reel") != std::string::npos || text.find("casting") != std::string::npos) {
-        player.load("fishing-reel.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("typing") != std::string::npos || text.find("keyboard") != std::string::npos || text.find("computer") != std::string::npos) {
+      clip = samples.get("clicking-keyboard.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("stove") != std::string::npos || text.find("gas") != std::string::npos || text.find("cooking") != std::string::npos) {
-        player.load("gasstove.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("pen") != std::string::npos || text.find("writing") != std::string::npos || text.find("click") != std::string::npos) {
+      clip = samples.get("clicking-pen.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("cleaning") != std::string::npos || text.find("glass") != std::string::npos || text.find("window") != std::string::npos) {
-        player.load("glass-cleaning-squeak.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("coffee") != std::string::npos || text.find("brewing") != std::string::npos || text.find("machine") != std::string::npos) {
+      clip = samples.get("coffee-machine.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("grocery") != std::string::npos || text.find("freezer") != std::string::npos || text.find("store") != std::string::npos) {
-        player.load("grocery-store-freezer-door.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("cutting") != std::string::npos || text.find("chopping") != std::string::npos || text.find("vegetables") != std::string::npos || text.find("fruit") != std::string::npos) {
+      clip = samples.get("cutfruitveg.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("guitar") != std::string::npos || text.find("tuning") != std::string::npos || text.find("strings") != std::string::npos) {
-        player.load("guitartuning.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("door") != std::string::npos || text.find("keys") != std::string::npos || text.find("unlocking") != std::string::npos) {
+      clip = samples.get("door-unlocking-with-keys.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("heartbeat") != std::string::npos || text.find("heart") != std::string::npos || text.find("pulse") != std::string::npos) {
-        player.load("heartbeat.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("drawer") != std::string::npos || text.find("opening") != std::string::npos || text.find("cabinet") != std::string::npos) {
+      clip = samples.get("drawer-opening.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("horses") != std::string::npos || text.find("riding") != std::string::npos) {
-        player.load("horses-kids.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("drawing") != std::string::npos || text.find("sketching") != std::string::npos || text.find("art") != std::string::npos) {
+      clip = samples.get("drawing.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("laundry") != std::string::npos || text.find("washing") != std::string::npos || text.find("clothes") != std::string::npos) {
-        player.load("laundry.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("fire") != std::string::npos || text.find("flames") != std::string::npos || text.find("burning") != std::string::npos) {
+      clip = samples.get("fire.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("market") != std::string::npos || text.find("crowd") != std::string::npos || text.find("busy") != std::string::npos) {
-        player.load("marketnoise.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("fishing") != std::string::npos || text.find("reel") != std::string::npos || text.find("casting") != std::string::npos) {
+      clip = samples.get("fishing-reel.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("microwave") != std::string::npos || text.find("heating") != std::string::npos || text.find("beeping") != std::string::npos) {
-        player.load("microwave.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("stove") != std::string::npos || text.find("gas") != std::string::npos || text.find("cooking") != std::string::npos) {
+      clip = samples.get("gasstove.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("soda") != std::string::npos || text.find("can") != std::string::npos || text.find("fizzy") != std::string::npos) {
-        player.load("opening-a-fizzy-can.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("cleaning") != std::string::npos || text.find("glass") != std::string::npos || text.find("window") != std::string::npos) {
+      clip = samples.get("glass-cleaning-squeak.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("pills") != std::string::npos || text.find("bottle") != std::string::npos || text.find("medicine") != std::string::npos) {
-        player.load("opening-pill-bottle.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("grocery") != std::string::npos || text.find("freezer") != std::string::npos || text.find("store") != std::string::npos) {
+      clip = samples.get("grocery-store-freezer-door.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("peeling") != std::string::npos || text.find("wood") != std::string::npos || text.find("scraping") != std::string::npos) {
-        player.load("peeling-wood.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("guitar") != std::string::npos || text.find("tuning") != std::string::npos || text.find("strings") != std::string::npos) {
+      clip = samples.get("guitartuning.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("cards") != std::string::npos || text.find("playing") != std::string::npos || text.find("shuffling") != std::string::npos) {
-        player.load("playingcards.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("heartbeat") != std::string::npos || text.find("heart") != std::string::npos || text.find("pulse") != std::string::npos) {
+      clip = samples.get("heartbeat.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("rain") != std::string::npos || text.find("raining") != std::string::npos || text.find("storm") != std::string::npos) {
-        player.load("rain-sounds.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("horses") != std::string::npos || text.find("riding") != std::string::npos) {
+      clip = samples.get("horses-kids.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("rolling") != std::string::npos || text.find("wheel") != std::string::npos || text.find("ball") != std::string::npos) {
-        player.load("rolling.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("laundry") != std::string::npos || text.find("washing") != std::string::npos || text.find("clothes") != std::string::npos) {
+      clip = samples.get("laundry.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("running") != std::string::npos || text.find("jogging") != std::string::npos || text.find("exercise") != std::string::npos) {
-        player.load("running.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("market") != std::string::npos || text.find("crowd") != std::string::npos || text.find("busy") != std::string::npos) {
+      clip = samples.get("marketnoise.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("eggs") != std::string::npos || text.find("scrambled") != std::string::npos || text.find("cooking") != std::string::npos) {
-        player.load("scrambled-egg.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("microwave") != std::string::npos || text.find("heating") != std::string::npos || text.find("beeping") != std::string::npos) {
+      clip = samples.get("microwave.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("brushing") != std::string::npos || text.find("teeth") != std::string::npos || text.find("sink") != std::string::npos) {
-        player.load("sink-and-toothbrush.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("soda") != std::string::npos || text.find("can") != std::string::npos || text.find("fizzy") != std::string::npos) {
+      clip = samples.get("opening-a-fizzy-can.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("skateboard") != std::string::npos || text.find("skating") != std::string::npos || text.find("wheels") != std::string::npos) {
-        player.load("skateboard.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("pills") != std::string::npos || text.find("bottle") != std::string::npos || text.find("medicine") != std::string::npos) {
+      clip = samples.get("opening-pill-bottle.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("spray") != std::string::npos || text.find("paint") != std::string::npos || text.find("graffiti") != std::string::npos) {
-        player.load("spray-paint-rattle-and-spray.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("peeling") != std::string::npos || text.find("wood") != std::string::npos || text.find("scraping") != std::string::npos) {
+      clip = samples.get("peeling-wood.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("stairs") != std::string::npos || text.find("jumping") != std::string::npos || text.find("steps") != std::string::npos) {
-        player.load("stairs-jumping.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("cards") != std::string::npos || text.find("playing") != std::string::npos || text.find("shuffling") != std::string::npos) {
+      clip = samples.get("playingcards.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("stapler") != std::string::npos || text.find("stapling") != std::string::npos || text.find("office") != std::string::npos) {
-        player.load("stapler-sound.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("rain") != std::string::npos || text.find("raining") != std::string::npos || text.find("storm") != std::string::npos) {
+      clip = samples.get("rain-sounds.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("gravel") != std::string::npos || text.find("stone") != std::string::npos || text.find("road") != std::string::npos) {
-        player.load("stone-road.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("rolling") != std::string::npos || text.find("wheel") != std::string::npos || text.find("ball") != std::string::npos) {
+      clip = samples.get("rolling.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("tapping") != std::string::npos || text.find("fingers") != std::string::npos || text.find("drumming") != std::string::npos) {
-        player.load("tapping-fingers.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("running") != std::string::npos || text.find("jogging") != std::string::npos || text.find("exercise") != std::string::npos) {
+      clip = samples.get("running.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("thunder") != std::string::npos || text.find("lightning") != std::string::npos || text.find("storm") != std::string::npos) {
-        player.load("thunder.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("eggs") != std::string::npos || text.find("scrambled") != std::string::npos || text.find("cooking") != std::string::npos) {
+      clip = samples.get("scrambled-egg.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("toaster") != std::string::npos || text.find("toast") != std::string::npos || text.find("bread") != std::string::npos) {
-        player.load("toaster.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("brushing") != std::string::npos || text.find("teeth") != std::string::npos || text.find("sink") != std::string::npos) {
+      clip = samples.get("sink-and-toothbrush.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("toy") != std::string::npos || text.find("guitar") != std::string::npos || text.find("music") != std::string::npos) {
-        player.load("toy-guitar-playing.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("skateboard") != std::string::npos || text.find("skating") != std::string::npos || text.find("wheels") != std::string::npos) {
+      clip = samples.get("skateboard.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("city") != std::string::npos || text.find("urban") != std::string::npos || text.find("traffic") != std::string::npos) {
-        player.load("traffic-in-city.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("spray") != std::string::npos || text.find("paint") != std::string::npos || text.find("graffiti") != std::string::npos) {
+      clip = samples.get("spray-paint-rattle-and-spray.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("walking") != std::string::npos || text.find("footsteps") != std::string::npos || text.find("steps") != std::string::npos) {
-        player.load("walking.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("stairs") != std::string::npos || text.find("jumping") != std::string::npos || text.find("steps") != std::string::npos) {
+      clip = samples.get("stairs-jumping.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("window") != std::string::npos || text.find("opening") != std::string::npos || text.find("fresh air") != std::string::npos) {
-        player.load("window-opening.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("stapler") != std::string::npos || text.find("stapling") != std::string::npos || text.find("office") != std::string::npos) {
+      clip = samples.get("stapler-sound.wav");
+      shouldPlaySound = true;
     }
-    
-      else if (text.find("wine") != std::string::npos || text.find("bottle") != std::string::npos || text.find("cork") != std::string::npos) {
-        player.load("winebottle.wav");
-        shouldPlaySound = true;
+
+    else if (text.find("gravel") != std::string::npos || text.find("stone") != std::string::npos || text.find("road") != std::string::npos) {
+      clip = samples.get("stone-road.wav");
+      shouldPlaySound = true;
     }
-      
-      else if (text.find("hungry") != std::string::npos) {
-        player.load("hungry.wav"); 
-        shouldPlaySound = true;
-      }
 
-      if (shouldPlaySound) {
-        player.reset(); // reset playback so it plays from the beginning
-        isAudioPlaying = true; // wont allow messages to be sent if true
+    else if (text.find("tapping") != std::string::npos || text.find("fingers") != std::string::npos || text.find("drumming") != std::string::npos) {
+      clip = samples.get("tapping-fingers.wav");
+      shouldPlaySound = true;
     }
 
-      // creates letter agents for each word if not frozen
-      if (!isFrozen && !isAudioPlaying) {
-        addWordsAsLetterAgents(text);
+    else if (text.find("thunder") != std::string::npos || text.find("lightning") != std::string::npos || text.find("storm") != std::string::npos) {
+      clip = samples.get("thunder.wav");
+      shouldPlaySound = true;
     }
+
+    else if (text.find("toaster") != std::string::npos || text.find("toast") != std::string::npos || text.find("bread") != std::string::npos) {
+      clip = samples.get("toaster.wav");
+      shouldPlaySound = true;
     }
-  } 
+
+    else if (text.find("toy") != std::string::npos || text.find("guitar") != std::string::npos || text.find("music") != std::string::npos) {
+      clip = samples.get("toy-guitar-playing.wav");
+      shouldPlaySound = true;
+    }
+
+    else if (text.find("city") != std::string::npos || text.find("urban") != std::string::npos || text.find("traffic") != std::string::npos) {
+      clip = samples.get("traffic-in-city.wav");
+      shouldPlaySound = true;
+    }
+
+    else if (text.find("walking") != std::string::npos || text.find("footsteps") != std::string::npos || text.find("steps") != std::string::npos) {
+      clip = samples.get("walking.wav");
+      shouldPlaySound = true;
+    }
+
+    else if (text.find("window") != std::string::npos || text.find("opening") != std::string::npos || text.find("fresh air") != std::string::npos) {
+      clip = samples.get("window-opening.wav");
+      shouldPlaySound = true;
+    }
+
+    else if (text.find("wine") != std::string::npos || text.find("bottle") != std::string::npos || text.find("cork") != std::string::npos) {
+      clip = samples.get("winebottle.wav");
+      shouldPlaySound = true;
+    }
+
+    else if (text.find("hungry") != std::string::npos) {
+      clip = samples.get("hungry.wav");
+      shouldPlaySound = true;
+    }
+
+    if (shouldPlaySound && clip != nullptr) {
+      playPos = 0; // plays from the beginning
+      isAudioPlaying.store(true, std::memory_order_release); // wont allow messages to be sent if true
+    }
+
+    // creates letter agents for each word if not frozen
+    if (!isFrozen && !isAudioPlaying) {
+      addWordsAsLetterAgents(text);
+    }
+  }
   
   void addWordsAsLetterAgents(const std::string& text) {
     std::vector<std::string> words = lineToWords(text);
@@ -618,6 +1107,12 @@ class MyApp : public App {
   }
 
   void onAnimate(double dt) override {
+    if (!offline.enabled) {
+      step(dt); // offline steps at a fixed dt from onDraw instead
+    }
+  }
+
+  void step(double dt) {
     if (!isFrozen) {
         globalTime += dt * speedMultiplier;
     }
@@ -629,6 +1124,68 @@ class MyApp : public App {
   }
 
   void onDraw(Graphics& g) override {
+    if (offline.enabled) {
+      renderOffline(g);
+    } else {
+      drawScene(g);
+    }
+  }
+
+  // renders as many fixed steps as fit in the budget, then shows the last frame
+  void renderOffline(Graphics& g) {
+    if (offline.finished) {
+      return;
+    }
+
+    auto tickStart = std::chrono::steady_clock::now();
+    while (!offline.done() &&
+           std::chrono::duration<double>(std::chrono::steady_clock::now() - tickStart).count() < offline.tickBudget) {
+      while (offline.nextLine < offline.lines.size() &&
+             offline.lines[offline.nextLine].first <= offline.simTime) {
+        handleTranscript(offline.lines[offline.nextLine].second, offline.simTime);
+        offline.nextLine++;
+      }
+
+      step(offline.dt);
+
+      // audio for exactly this step, so the mix stays in sync with the frames
+      int rate = samples.sampleRate;
+      int channels = samples.channels;
+      long first = long(offline.simTime * rate);
+      long last = long((offline.simTime + offline.dt) * rate);
+      size_t offset = offline.audio.size();
+      offline.audio.resize(offset + (last - first) * channels);
+      for (long i = 0; i < last - first; i++) {
+        renderFrame(&offline.audio[offset + i * channels], channels);
+      }
+
+      g.pushFramebuffer(offlineFbo);
+      g.pushViewport(offline.width, offline.height);
+      g.pushCamera(view());
+      drawScene(g);
+      g.popCamera();
+
+      glReadPixels(0, 0, offline.width, offline.height, GL_RGBA, GL_UNSIGNED_BYTE, offlinePixels.data());
+      g.popViewport();
+      g.popFramebuffer();
+      Image::saveImage(offline.framePath(), offlinePixels.data(), offline.width, offline.height, true, 4);
+
+      offline.frame++;
+      offline.simTime += offline.dt;
+    }
+
+    g.clear(0);
+    g.quadViewport(offlineFbo.tex());
+
+    if (offline.done()) {
+      offline.writeWav(samples.sampleRate, samples.channels);
+      offline.report();
+      offline.finished = true;
+      quit();
+    }
+  }
+
+  void drawScene(Graphics& g) {
     g.clear(background);
     g.blending(true);
     g.blendTrans();
@@ -688,27 +1245,71 @@ class MyApp : public App {
   }
 
   void onSound(AudioIOData& io) override {
+    // app starts a default audio device even offline, where the mix is
+    // rendered from the graphics thread instead, so stay silent
+    if (offline.enabled) {
+        while (io()) {
+            for (int c = 0; c < io.channelsOut(); c++) {
+                io.out(c) = 0.0f;
+            }
+        }
+        return;
+    }
+
+    int outChannels = std::min(io.channelsOut(), int(soundFrame.size()));
     while (io()) {
+        renderFrame(soundFrame.data(), outChannels);
+        for (int c = 0; c < outChannels; c++) {
+            io.out(c) = soundFrame[c];
+        }
+    }
+  }
+
+  // writes one frame of the current clip to out
+  void renderFrame(float* out, int outChannels) {
+    if (outChannels == 0) {
+        return; // nothing to write to, so don't advance playback either
+    }
+    float power = 0.0f;
+    bool playing = isAudioPlaying.load(std::memory_order_acquire); // clip and playPos are ready once this is true
+
+    for (int c = 0; c < outChannels; c++) {
         float s = 0.0f;
-        
-        if (isAudioPlaying) {
-            s = player() * 0.8f;
-            
-            // check if the sample has finished playing
-            if (player.pos() >= player.frames() - 1) {
-                isAudioPlaying = false; // allow new messages? no
-                player.reset(); // reset for next time
-            }
+        if (playing) {
+            s = clip->data[playPos * clip->channels + c % clip->channels]; // already at device rate
+        }
+        out[c] = s;
+        power += s * s;
+    }
+
+    if (playing) {
+        playPos++;
+
+        // check if the sample has finished playing
+        if (playPos >= clip->frames) {
+            playPos = 0; // reset for next time
+            isAudioPlaying.store(false, std::memory_order_release); // allow new messages? no
         }
-        
-        level = 0.997f * level + 0.003f * s * s;
-        io.out(0) = s;
-        io.out(1) = s;
     }
+
+    level = 0.997f * level + 0.003f * power / outChannels;
 }}; 
 
-int main() { 
+// ./story                                  live, listening for /whisper
+// ./story --offline transcript.txt [dir]   render a script to frames + mix.wav
+int main(int argc, char* argv[]) { 
     MyApp app;
-    app.configureAudio(44100, 512, 2, 2);
+    if (argc > 1 && std::string(argv[1]) == "--offline") {
+        if (argc < 3) {
+            std::cout << "usage: " << argv[0] << " --offline transcript.txt [dir]" << std::endl;
+            return 1;
+        }
+        if (!app.offline.load(argv[2], argc > 3 ? argv[3] : "render/")) {
+            return 1;
+        }
+        app.dimensions(app.offline.width, app.offline.height); // the mix is rendered offline, onSound stays silent
+    } else {
+        app.configureAudio(44100, 512, 2, 2);
+    }
     app.start(); 
 }